@@ -12,6 +12,13 @@
 #include <sstream>
 #include <iostream>
 #include <array>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
 
 #define CU_COMP_TIME static constexpr
 #define CU_FUNC static
@@ -51,13 +58,14 @@ using static_mem_t = std::array<T, N>;
 
 // We (hopefully) avoid UB by calculating everything up front with the highest word size
 // and then converting after the fact.
-template <default_word_t tnum_lines_per_set, default_word_t tnum_bytes_per_block, default_word_t tnum_cache_bytes, default_word_t tnum_physical_address_bits>
+template <default_word_t tnum_lines_per_set, default_word_t tnum_bytes_per_block, default_word_t tnum_cache_bytes, default_word_t tnum_physical_address_bits, default_word_t tnum_bytes_per_page = 1 << 12>
 struct cache_base
 {
 	CU_COMP_TIME default_word_t num_lines_per_set = tnum_lines_per_set;
 	CU_COMP_TIME default_word_t num_bytes_per_block = tnum_bytes_per_block;
 	CU_COMP_TIME default_word_t num_cache_bytes = tnum_cache_bytes;
 	CU_COMP_TIME default_word_t num_physical_address_bits = tnum_physical_address_bits;
+	CU_COMP_TIME default_word_t num_bytes_per_page = tnum_bytes_per_page;
 
 	CU_COMP_TIME default_word_t num_sets = num_cache_bytes / (num_lines_per_set * num_bytes_per_block);
 	CU_COMP_TIME default_word_t num_set_index_bits = detail::log2i(num_sets);
@@ -82,6 +90,7 @@ struct cache_base
 	decl_prefix word_t num_bytes_per_block = CU_CAST_CACHE_BASE(word_t, num_bytes_per_block);	\
 	decl_prefix word_t num_cache_bytes = CU_CAST_CACHE_BASE(word_t, num_cache_bytes); \
 	decl_prefix word_t num_physical_address_bits = CU_CAST_CACHE_BASE(word_t, num_physical_address_bits); \
+	decl_prefix word_t num_bytes_per_page = CU_CAST_CACHE_BASE(word_t, num_bytes_per_page); \
 																									\
 	decl_prefix word_t num_sets = CU_CAST_CACHE_BASE(word_t, num_sets);									\
 	decl_prefix word_t num_set_index_bits = CU_CAST_CACHE_BASE(word_t, num_set_index_bits);				\
@@ -104,7 +113,7 @@ struct cache_cast {
 	CU_CACHE_PARAMS_DECL(word_t, CU_COMP_TIME)
 };
 
-using arch_x86_64_cache_base = cache_base<8, 64, 1 << 15, 48>;
+using arch_x86_64_cache_base = cache_base<8, 64, 1 << 15, 48, 1 << 12>;
 
 using arch_x86_64_cache_reg_wordq = cache_cast<std::uint64_t, arch_x86_64_cache_base>;
 using arch_x86_64_cache_reg_wordd = cache_cast<std::uint32_t, arch_x86_64_cache_base>;
@@ -116,7 +125,7 @@ using x64rwd = arch_x86_64_cache_reg_wordd;
 using x64rw = arch_x86_64_cache_reg_word;
 using x64rb = arch_x86_64_cache_reg_byte;
 
-using arch_x86_cache_base = cache_base<8, 64, 1 << 15, 32>;
+using arch_x86_cache_base = cache_base<8, 64, 1 << 15, 32, 1 << 12>;
 
 using arch_x86_cache_reg_wordd = cache_cast<std::uint32_t, arch_x86_cache_base>;
 using arch_x86_cache_reg_word = cache_cast<std::uint16_t, arch_x86_cache_base>;
@@ -332,6 +341,525 @@ CU_FUNC_COMP_TIME member_return_type<offset, memType, Args...> & member(cache_me
 	return detail::get_member_impl<offset, cache_mem, memType, Args...>::call_array_static<index>(s.mem);
 }
 
+//----------------------------------------------
+// tiled 2D arrays
+//----------------------------------------------
+
+// Elements are grouped into tiles of tnum_tile_bytes, each tile being a small
+// row-major block. The tiles themselves are stored either row-major or in Z-order (Morton),
+// so that neighboring tiles in both x and y tend to share a page.
+
+enum tile_order {
+	tile_order_row_major = 0,
+	tile_order_morton
+};
+
+namespace detail {
+
+CU_COMP_TIME default_word_t floor_log2i(default_word_t n)
+{
+	return (n < 2) ? 0 : 1 + floor_log2i(n / 2);
+}
+
+CU_COMP_TIME default_word_t next_pow2i(default_word_t n)
+{
+	return (n < 2) ? 1 : 2 * next_pow2i((n + 1) / 2);
+}
+
+// Spreads the low 32 bits of x out so that there's a zero bit between each of them
+CU_FUNC_COMP_TIME default_word_t morton_spread(default_word_t x)
+{
+	x &= 0x00000000ffffffffull;
+	x = (x | (x << 16)) & 0x0000ffff0000ffffull;
+	x = (x | (x << 8)) & 0x00ff00ff00ff00ffull;
+	x = (x | (x << 4)) & 0x0f0f0f0f0f0f0f0full;
+	x = (x | (x << 2)) & 0x3333333333333333ull;
+	x = (x | (x << 1)) & 0x5555555555555555ull;
+	return x;
+}
+
+// Inverse of morton_spread: gathers every even bit of x into the low 32 bits
+CU_FUNC_COMP_TIME default_word_t morton_compact(default_word_t x)
+{
+	x &= 0x5555555555555555ull;
+	x = (x | (x >> 1)) & 0x3333333333333333ull;
+	x = (x | (x >> 2)) & 0x0f0f0f0f0f0f0f0full;
+	x = (x | (x >> 4)) & 0x00ff00ff00ff00ffull;
+	x = (x | (x >> 8)) & 0x0000ffff0000ffffull;
+	x = (x | (x >> 16)) & 0x00000000ffffffffull;
+	return x;
+}
+
+} // end namespace detail
+
+template <typename T, default_word_t tnum_tile_bytes = cache_params_t::num_bytes_per_block, tile_order ttile_order = tile_order_row_major>
+struct tiled_array2d {
+	using this_type = T;
+	using size_type = default_word_t;
+
+	static_assert((tnum_tile_bytes & (tnum_tile_bytes - 1)) == 0, "tile size must be a power of two");
+	static_assert((sizeof(this_type) & (sizeof(this_type) - 1)) == 0, "element size must be a power of two");
+	static_assert(sizeof(this_type) <= tnum_tile_bytes, "element doesn't fit in a tile");
+
+	CU_COMP_TIME tile_order order = ttile_order;
+
+	CU_COMP_TIME size_type tile_length = tnum_tile_bytes / sizeof(this_type);
+	CU_COMP_TIME size_type num_tile_bits = detail::floor_log2i(tile_length);
+
+	// odd bit counts give the extra bit to x, so a tile is never taller than it is wide
+	CU_COMP_TIME size_type num_tile_width_bits = (num_tile_bits + 1) / 2;
+	CU_COMP_TIME size_type num_tile_height_bits = num_tile_bits / 2;
+
+	CU_COMP_TIME size_type tile_width = 1ull << num_tile_width_bits;
+	CU_COMP_TIME size_type tile_height = 1ull << num_tile_height_bits;
+
+	CU_COMP_TIME size_type tile_x_mask = tile_width - 1;
+	CU_COMP_TIME size_type tile_y_mask = tile_height - 1;
+
+	struct alignas(tnum_tile_bytes) tile_type {
+		detail::static_mem_t<this_type, tile_length> mem;
+	};
+
+	template <typename valueType>
+	struct basic_tile_ref {
+		valueType *mem;
+
+		// origin of the tile, in elements
+		size_type x;
+		size_type y;
+
+		// clipped against the extent of the array
+		size_type width;
+		size_type height;
+
+		valueType & operator()(size_type local_x, size_type local_y) const
+		{
+			return mem[local_x | (local_y << num_tile_width_bits)];
+		}
+	};
+
+	template <typename ownerType, typename valueType>
+	struct basic_tile_iterator {
+		ownerType *owner;
+		size_type index;
+
+		basic_tile_ref<valueType> operator*() const
+		{
+			return owner->tile_at(index);
+		}
+
+		basic_tile_iterator & operator++()
+		{
+			index = owner->next_tile_index(index + 1);
+			return *this;
+		}
+
+		bool operator==(const basic_tile_iterator &other) const { return index == other.index; }
+		bool operator!=(const basic_tile_iterator &other) const { return index != other.index; }
+	};
+
+	template <typename ownerType, typename valueType>
+	struct basic_tile_range {
+		using iterator = basic_tile_iterator<ownerType, valueType>;
+
+		ownerType *owner;
+
+		iterator begin() const { return { owner, owner->next_tile_index(0) }; }
+		iterator end() const { return { owner, owner->mem.size() }; }
+	};
+
+	using tile_ref = basic_tile_ref<this_type>;
+	using const_tile_ref = basic_tile_ref<const this_type>;
+	using tile_range = basic_tile_range<tiled_array2d, this_type>;
+	using const_tile_range = basic_tile_range<const tiled_array2d, const this_type>;
+
+	size_type width{};
+	size_type height{};
+
+	size_type num_tiles_x{};
+	size_type num_tiles_y{};
+
+	// Only used for Z-order: the tile grid is padded out to powers of two along each axis.
+	// The low (2 * num_morton_bits) bits of a tile index are interleaved,
+	// and whatever is left over from the longer axis is stored above them.
+	size_type num_tiles_x_bits{};
+	size_type num_tiles_y_bits{};
+	size_type num_morton_bits{};
+
+	std::vector<tile_type> mem;
+
+	tiled_array2d() = default;
+
+	tiled_array2d(size_type w, size_type h)
+		: width(w),
+		  height(h),
+		  num_tiles_x((w + tile_x_mask) >> num_tile_width_bits),
+		  num_tiles_y((h + tile_y_mask) >> num_tile_height_bits)
+	{
+		CU_STATIC_IF (order == tile_order_morton) {
+			num_tiles_x = detail::next_pow2i(num_tiles_x);
+			num_tiles_y = detail::next_pow2i(num_tiles_y);
+
+			num_tiles_x_bits = detail::floor_log2i(num_tiles_x);
+			num_tiles_y_bits = detail::floor_log2i(num_tiles_y);
+			num_morton_bits = num_tiles_x_bits < num_tiles_y_bits ? num_tiles_x_bits : num_tiles_y_bits;
+		}
+
+		mem.resize(num_tiles_x * num_tiles_y);
+	}
+
+	size_type tile_index(size_type tile_x, size_type tile_y) const
+	{
+		CU_STATIC_IF (order == tile_order_morton) {
+			const size_type low_mask = (1ull << num_morton_bits) - 1ull;
+
+			size_type low = detail::morton_spread(tile_x & low_mask) | (detail::morton_spread(tile_y & low_mask) << 1);
+
+			// at most one of these is non-zero
+			size_type high = (tile_x >> num_morton_bits) | (tile_y >> num_morton_bits);
+
+			return low | (high << (num_morton_bits << 1));
+		} else {
+			return tile_y * num_tiles_x + tile_x;
+		}
+	}
+
+	void tile_coords(size_type index, size_type &tile_x, size_type &tile_y) const
+	{
+		CU_STATIC_IF (order == tile_order_morton) {
+			const size_type low_bits = num_morton_bits << 1;
+			const size_type low = index & ((1ull << low_bits) - 1ull);
+			const size_type high = index >> low_bits;
+
+			tile_x = detail::morton_compact(low);
+			tile_y = detail::morton_compact(low >> 1);
+
+			if (num_tiles_x_bits > num_morton_bits) {
+				tile_x |= high << num_morton_bits;
+			} else {
+				tile_y |= high << num_morton_bits;
+			}
+		} else {
+			tile_x = index % num_tiles_x;
+			tile_y = index / num_tiles_x;
+		}
+	}
+
+	CU_FUNC_COMP_TIME size_type element_offset(size_type x, size_type y)
+	{
+		return (x & tile_x_mask) | ((y & tile_y_mask) << num_tile_width_bits);
+	}
+
+	this_type & operator()(size_type x, size_type y)
+	{
+		return mem[tile_index(x >> num_tile_width_bits, y >> num_tile_height_bits)].mem[element_offset(x, y)];
+	}
+
+	const this_type & operator()(size_type x, size_type y) const
+	{
+		return mem[tile_index(x >> num_tile_width_bits, y >> num_tile_height_bits)].mem[element_offset(x, y)];
+	}
+
+	// Z-order pads the tile grid, so some tiles may lie entirely outside of the array
+	size_type next_tile_index(size_type index) const
+	{
+		for (; index < mem.size(); ++index) {
+			size_type tile_x, tile_y;
+			tile_coords(index, tile_x, tile_y);
+
+			if ((tile_x << num_tile_width_bits) < width && (tile_y << num_tile_height_bits) < height) {
+				break;
+			}
+		}
+
+		return index;
+	}
+
+	tile_ref tile_at(size_type index)
+	{
+		return make_tile_ref<this_type>(mem[index].mem.data(), index);
+	}
+
+	const_tile_ref tile_at(size_type index) const
+	{
+		return make_tile_ref<const this_type>(mem[index].mem.data(), index);
+	}
+
+	tile_range tiles() { return { this }; }
+	const_tile_range tiles() const { return { this }; }
+
+	void fill(const this_type &value)
+	{
+		for (auto &t: mem) {
+			t.mem.fill(value);
+		}
+	}
+
+private:
+	template <typename valueType>
+	basic_tile_ref<valueType> make_tile_ref(valueType *p, size_type index) const
+	{
+		size_type tile_x, tile_y;
+		tile_coords(index, tile_x, tile_y);
+
+		const size_type x = tile_x << num_tile_width_bits;
+		const size_type y = tile_y << num_tile_height_bits;
+
+		return {
+			p,
+			x,
+			y,
+			(width - x) < tile_width ? (width - x) : tile_width,
+			(height - y) < tile_height ? (height - y) : tile_height
+		};
+	}
+};
+
+template <typename T, default_word_t tnum_page_bytes = cache_params_t::num_bytes_per_page>
+using tiled_morton_array2d = tiled_array2d<T, tnum_page_bytes, tile_order_morton>;
+
+// Writes the transpose of src into dst, which must be src.height x src.width and can't be src.
+// Walks src one tile at a time so each source tile is read once while it's hot;
+// when the tiles are square every source tile maps onto exactly one destination tile.
+template <typename T, default_word_t tnum_tile_bytes, tile_order ttile_order>
+CU_FUNC bool transpose(const tiled_array2d<T, tnum_tile_bytes, ttile_order> &src, tiled_array2d<T, tnum_tile_bytes, ttile_order> &dst)
+{
+	using array_t = tiled_array2d<T, tnum_tile_bytes, ttile_order>;
+	using size_type = typename array_t::size_type;
+
+	if (&src == &dst || dst.width != src.height || dst.height != src.width) {
+		return false;
+	}
+
+	for (const auto &s: src.tiles()) {
+		CU_STATIC_IF (array_t::tile_width == array_t::tile_height) {
+			auto &d = dst.mem[dst.tile_index(s.y >> array_t::num_tile_height_bits, s.x >> array_t::num_tile_width_bits)].mem;
+
+			for (size_type y = 0; y < array_t::tile_height; ++y) {
+				for (size_type x = 0; x < array_t::tile_width; ++x) {
+					d[y | (x << array_t::num_tile_width_bits)] = s(x, y);
+				}
+			}
+		} else {
+			for (size_type y = 0; y < s.height; ++y) {
+				for (size_type x = 0; x < s.width; ++x) {
+					dst(s.y + y, s.x + x) = s(x, y);
+				}
+			}
+		}
+	}
+
+	return true;
+}
+
+//----------------------------------------------
+// bounded lock-free queues
+//----------------------------------------------
+
+// Both queues hand out positions from ever increasing indices and mask them down to a slot,
+// so tcapacity has to be a power of two. The head and tail indices each get their own line
+// so producers and consumers aren't fighting over the same one.
+//
+// push_n/pop_n move as many of the n items as will fit/are available and return the count.
+// Queueing cache_mem/cache_blocked_t values moves whole blocks per slot.
+
+template <typename T, default_word_t tcapacity>
+struct spsc_ring {
+	using this_type = T;
+	using size_type = default_word_t;
+
+	static_assert(tcapacity != 0 && (tcapacity & (tcapacity - 1)) == 0, "capacity must be a power of two");
+
+	CU_COMP_TIME size_type capacity = tcapacity;
+	CU_COMP_TIME size_type index_mask = capacity - 1;
+	CU_COMP_TIME size_type line_bytes = cache_params_t::num_bytes_per_block;
+
+	// Consumer's line: the index it publishes, plus the last tail it saw.
+	// It only goes back to the producer's line once it runs out of what it knows is there.
+	alignas(line_bytes) std::atomic<size_type> head{};
+	size_type tail_cache{};
+
+	// Producer's line, same idea
+	alignas(line_bytes) std::atomic<size_type> tail{};
+	size_type head_cache{};
+
+	alignas(line_bytes) detail::static_mem_t<this_type, capacity> mem;
+
+	size_type push_n(const this_type *items, size_type n)
+	{
+		const size_type t = tail.load(std::memory_order_relaxed);
+
+		if (capacity - (t - head_cache) < n) {
+			head_cache = head.load(std::memory_order_acquire);
+		}
+
+		const size_type free_count = capacity - (t - head_cache);
+		n = n < free_count ? n : free_count;
+
+		if (n == 0) {
+			return 0;
+		}
+
+		const size_type first = t & index_mask;
+		const size_type run = (capacity - first) < n ? (capacity - first) : n;
+
+		std::copy_n(items, run, mem.data() + first);
+		std::copy_n(items + run, n - run, mem.data());
+
+		tail.store(t + n, std::memory_order_release);
+
+		return n;
+	}
+
+	size_type pop_n(this_type *items, size_type n)
+	{
+		const size_type h = head.load(std::memory_order_relaxed);
+
+		if (tail_cache - h < n) {
+			tail_cache = tail.load(std::memory_order_acquire);
+		}
+
+		const size_type used_count = tail_cache - h;
+		n = n < used_count ? n : used_count;
+
+		if (n == 0) {
+			return 0;
+		}
+
+		const size_type first = h & index_mask;
+		const size_type run = (capacity - first) < n ? (capacity - first) : n;
+
+		std::copy_n(mem.data() + first, run, items);
+		std::copy_n(mem.data(), n - run, items + run);
+
+		head.store(h + n, std::memory_order_release);
+
+		return n;
+	}
+
+	bool push(const this_type &item) { return push_n(&item, 1) == 1; }
+	bool pop(this_type &item) { return pop_n(&item, 1) == 1; }
+};
+
+// Bounded MPMC queue after Vyukov: every slot carries a sequence number telling whether
+// it's free for the current lap (sequence == position) or ready to be read (sequence == position + 1).
+// Producers and consumers never read each other's index; the slot sequences stand in for it,
+// which is the MPMC equivalent of the SPSC index caching above.
+//
+// A batch claims the longest run of consecutive usable slots with a single CAS.
+
+template <typename T, default_word_t tcapacity>
+struct mpmc_ring {
+	using this_type = T;
+	using size_type = default_word_t;
+	using diff_type = std::int64_t;
+
+	static_assert(tcapacity != 0 && (tcapacity & (tcapacity - 1)) == 0, "capacity must be a power of two");
+
+	CU_COMP_TIME size_type capacity = tcapacity;
+	CU_COMP_TIME size_type index_mask = capacity - 1;
+	CU_COMP_TIME size_type line_bytes = cache_params_t::num_bytes_per_block;
+
+	// The value comes first so a line sized block stays on exactly one line;
+	// the sequence goes after it, on the next line in that case.
+	struct slot {
+		alignas(line_bytes) this_type value;
+		std::atomic<size_type> sequence;
+	};
+
+	alignas(line_bytes) std::atomic<size_type> head{};
+	alignas(line_bytes) std::atomic<size_type> tail{};
+	alignas(line_bytes) detail::static_mem_t<slot, capacity> mem;
+
+	mpmc_ring()
+	{
+		for (size_type i = 0; i < capacity; ++i) {
+			mem[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	size_type push_n(const this_type *items, size_type n)
+	{
+		if (n == 0) {
+			return 0;
+		}
+
+		size_type pos = tail.load(std::memory_order_relaxed);
+
+		for (;;) {
+			const size_type count = claimable(pos, n, 0);
+
+			if (count == 0) {
+				const size_type seq = mem[pos & index_mask].sequence.load(std::memory_order_acquire);
+
+				// still holding last lap's value: full
+				if (static_cast<diff_type>(seq - pos) < 0) {
+					return 0;
+				}
+
+				pos = tail.load(std::memory_order_relaxed);
+			} else if (tail.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+				for (size_type i = 0; i < count; ++i) {
+					slot &s = mem[(pos + i) & index_mask];
+					s.value = items[i];
+					s.sequence.store(pos + i + 1, std::memory_order_release);
+				}
+
+				return count;
+			}
+		}
+	}
+
+	size_type pop_n(this_type *items, size_type n)
+	{
+		if (n == 0) {
+			return 0;
+		}
+
+		size_type pos = head.load(std::memory_order_relaxed);
+
+		for (;;) {
+			const size_type count = claimable(pos, n, 1);
+
+			if (count == 0) {
+				const size_type seq = mem[pos & index_mask].sequence.load(std::memory_order_acquire);
+
+				// nothing written here yet: empty
+				if (static_cast<diff_type>(seq - (pos + 1)) < 0) {
+					return 0;
+				}
+
+				pos = head.load(std::memory_order_relaxed);
+			} else if (head.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+				for (size_type i = 0; i < count; ++i) {
+					slot &s = mem[(pos + i) & index_mask];
+					items[i] = s.value;
+					s.sequence.store(pos + i + capacity, std::memory_order_release);
+				}
+
+				return count;
+			}
+		}
+	}
+
+	bool push(const this_type &item) { return push_n(&item, 1) == 1; }
+	bool pop(this_type &item) { return pop_n(&item, 1) == 1; }
+
+private:
+	// Number of slots, starting at pos, whose sequence equals their position + offset.
+	// Nobody else can touch them until the index moves past pos, so winning the CAS makes them ours.
+	size_type claimable(size_type pos, size_type n, size_type offset) const
+	{
+		size_type count = 0;
+
+		while (count < n && mem[(pos + count) & index_mask].sequence.load(std::memory_order_acquire) == pos + count + offset) {
+			++count;
+		}
+
+		return count;
+	}
+};
+
 //----------------------------------------------
 // con
 //----------------------------------------------
@@ -568,6 +1096,524 @@ CU_FUNC void vertex_array_test(bool print_vals, std::size_t iterations)
 
 using vertex_array_test_benchmark_t = CU_BENCHMARK_TYPE(vertex_array_test);
 
+#define CU_GRID_TEST_DIM 1024
+#define CU_GRID_IN_ITERATIONS 1
+
+using grid_row_major_t = std::vector<float>;
+using grid_tiled_t = tiled_morton_array2d<float>;
+
+struct grid_test_data {
+	grid_row_major_t row_src;
+	grid_row_major_t row_dst;
+
+	grid_tiled_t tiled_src;
+	grid_tiled_t tiled_dst;
+
+	grid_test_data()
+		: row_src(CU_GRID_TEST_DIM * CU_GRID_TEST_DIM),
+		  row_dst(CU_GRID_TEST_DIM * CU_GRID_TEST_DIM),
+		  tiled_src(CU_GRID_TEST_DIM, CU_GRID_TEST_DIM),
+		  tiled_dst(CU_GRID_TEST_DIM, CU_GRID_TEST_DIM)
+	{
+		for (std::size_t y = 0; y < CU_GRID_TEST_DIM; ++y) {
+			for (std::size_t x = 0; x < CU_GRID_TEST_DIM; ++x) {
+				float v = static_cast<float>((x * 7 + y * 13) & 0xff);
+
+				row_src[y * CU_GRID_TEST_DIM + x] = v;
+				tiled_src(x, y) = v;
+			}
+		}
+	}
+};
+
+// Allocated once up front so the benchmarks only measure the traversal
+CU_FUNC grid_test_data & grid_data()
+{
+	static grid_test_data data;
+	return data;
+}
+
+CU_FUNC float grid_row_checksum(const grid_row_major_t &g)
+{
+	float sum = 0.0f;
+	for (float v: g) {
+		sum += v;
+	}
+	return sum;
+}
+
+CU_FUNC float grid_tiled_checksum(const grid_tiled_t &g)
+{
+	float sum = 0.0f;
+	for (std::size_t y = 0; y < g.height; ++y) {
+		for (std::size_t x = 0; x < g.width; ++x) {
+			sum += g(x, y);
+		}
+	}
+	return sum;
+}
+
+// 5 point stencil; the outer border is left untouched
+
+CU_FUNC void grid_row_stencil_test(bool print_vals, std::size_t iterations)
+{
+	constexpr std::size_t dim = CU_GRID_TEST_DIM;
+
+	auto &data = grid_data();
+	const auto &src = data.row_src;
+	auto &dst = data.row_dst;
+
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (std::size_t y = 1; y < dim - 1; ++y) {
+			for (std::size_t x = 1; x < dim - 1; ++x) {
+				dst[y * dim + x] = 0.2f * (src[y * dim + x]
+					+ src[y * dim + x - 1] + src[y * dim + x + 1]
+					+ src[(y - 1) * dim + x] + src[(y + 1) * dim + x]);
+			}
+		}
+	}
+
+	if (print_vals) {
+		std::cout << "checksum: " << grid_row_checksum(dst) << std::endl;
+	}
+}
+
+using grid_row_stencil_test_benchmark_t = CU_BENCHMARK_TYPE(grid_row_stencil_test);
+
+CU_FUNC void grid_tiled_stencil_test(bool print_vals, std::size_t iterations)
+{
+	constexpr std::size_t dim = CU_GRID_TEST_DIM;
+	constexpr std::size_t tw = grid_tiled_t::tile_width;
+	constexpr std::size_t th = grid_tiled_t::tile_height;
+
+	auto &data = grid_data();
+	const auto &src = data.tiled_src;
+	auto &dst = data.tiled_dst;
+
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (const auto &s: src.tiles()) {
+			auto d = dst.tile_at(dst.tile_index(s.x / tw, s.y / th));
+
+			for (std::size_t ly = 0; ly < s.height; ++ly) {
+				const std::size_t y = s.y + ly;
+
+				if (y == 0 || y == dim - 1) {
+					continue;
+				}
+
+				for (std::size_t lx = 0; lx < s.width; ++lx) {
+					const std::size_t x = s.x + lx;
+
+					if (x == 0 || x == dim - 1) {
+						continue;
+					}
+
+					// neighbors inside the tile are a shift and an or away;
+					// only the tile's rim has to go through the full mapping
+					if (lx > 0 && lx < s.width - 1 && ly > 0 && ly < s.height - 1) {
+						d(lx, ly) = 0.2f * (s(lx, ly)
+							+ s(lx - 1, ly) + s(lx + 1, ly)
+							+ s(lx, ly - 1) + s(lx, ly + 1));
+					} else {
+						d(lx, ly) = 0.2f * (src(x, y)
+							+ src(x - 1, y) + src(x + 1, y)
+							+ src(x, y - 1) + src(x, y + 1));
+					}
+				}
+			}
+		}
+	}
+
+	if (print_vals) {
+		std::cout << "checksum: " << grid_tiled_checksum(dst) << std::endl;
+	}
+}
+
+using grid_tiled_stencil_test_benchmark_t = CU_BENCHMARK_TYPE(grid_tiled_stencil_test);
+
+CU_FUNC void grid_row_transpose_test(bool print_vals, std::size_t iterations)
+{
+	constexpr std::size_t dim = CU_GRID_TEST_DIM;
+
+	auto &data = grid_data();
+	const auto &src = data.row_src;
+	auto &dst = data.row_dst;
+
+	for (std::size_t i = 0; i < iterations; ++i) {
+		for (std::size_t y = 0; y < dim; ++y) {
+			for (std::size_t x = 0; x < dim; ++x) {
+				dst[x * dim + y] = src[y * dim + x];
+			}
+		}
+	}
+
+	if (print_vals) {
+		std::cout << "checksum: " << grid_row_checksum(dst) << std::endl;
+	}
+}
+
+using grid_row_transpose_test_benchmark_t = CU_BENCHMARK_TYPE(grid_row_transpose_test);
+
+CU_FUNC void grid_tiled_transpose_test(bool print_vals, std::size_t iterations)
+{
+	auto &data = grid_data();
+
+	for (std::size_t i = 0; i < iterations; ++i) {
+		transpose(data.tiled_src, data.tiled_dst);
+	}
+
+	if (print_vals) {
+		std::size_t mismatches = 0;
+
+		for (std::size_t y = 0; y < data.tiled_src.height; ++y) {
+			for (std::size_t x = 0; x < data.tiled_src.width; ++x) {
+				mismatches += data.tiled_dst(y, x) != data.tiled_src(x, y);
+			}
+		}
+
+		std::cout << "checksum: " << grid_tiled_checksum(data.tiled_dst) << "\n"
+				  << CU_STREAM_VALUE(mismatches)
+				  << std::endl;
+	}
+}
+
+using grid_tiled_transpose_test_benchmark_t = CU_BENCHMARK_TYPE(grid_tiled_transpose_test);
+
+#define CU_QUEUE_CAPACITY 1024
+#define CU_QUEUE_BATCH 8
+#define CU_QUEUE_IN_ITERATIONS (1 << 14)
+#define CU_QUEUE_LATENCY_IN_ITERATIONS (1 << 10)
+
+// one line of records per slot
+using queue_block_t = cache_blocked_t<std::uint64_t>;
+
+using spsc_queue_test_t = spsc_ring<queue_block_t, CU_QUEUE_CAPACITY>;
+using mpmc_queue_test_t = mpmc_ring<queue_block_t, CU_QUEUE_CAPACITY>;
+
+// What we're trying to beat
+template <typename T>
+struct locked_deque {
+	using this_type = T;
+	using size_type = default_word_t;
+
+	std::mutex lock;
+	std::deque<this_type> mem;
+
+	size_type push_n(const this_type *items, size_type n)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		mem.insert(mem.end(), items, items + n);
+		return n;
+	}
+
+	size_type pop_n(this_type *items, size_type n)
+	{
+		std::lock_guard<std::mutex> guard(lock);
+
+		n = n < mem.size() ? n : mem.size();
+		std::copy_n(mem.begin(), n, items);
+		mem.erase(mem.begin(), mem.begin() + n);
+
+		return n;
+	}
+};
+
+using deque_queue_test_t = locked_deque<queue_block_t>;
+
+template <typename queueType>
+CU_FUNC void queue_push_all(queueType &q, const queue_block_t *items, std::size_t n)
+{
+	while (n != 0) {
+		const std::size_t count = q.push_n(items, n);
+
+		if (count == 0) {
+			YieldProcessor();
+		}
+
+		items += count;
+		n -= count;
+	}
+}
+
+template <typename queueType>
+CU_FUNC void queue_pop_all(queueType &q, queue_block_t *items, std::size_t n)
+{
+	while (n != 0) {
+		const std::size_t count = q.pop_n(items, n);
+
+		if (count == 0) {
+			YieldProcessor();
+		}
+
+		items += count;
+		n -= count;
+	}
+}
+
+// The queue tests time themselves, from the moment every thread is spun up and waiting
+// until the last block comes through, so queue allocation and thread spawn/join stay out of it.
+// They hand back raw counter ticks; handoff_benchmark turns those into time per handoff.
+struct handoff_stats {
+	LONGLONG ticks{};
+	std::size_t num_handoffs{};
+
+	DWORD win_error_code = ERROR_SUCCESS;
+};
+
+template <template_int_t tnum_iterations>
+struct handoff_benchmark {
+	using run_func_type = bool (*)(handoff_stats &, bool, std::size_t);
+
+	using bench_time_t = double;
+
+	handoff_stats stats{};
+
+	bench_time_t time_value_per_handoff{};
+	bench_time_t win_time_perf_frequency{};
+
+	DWORD	win_error_code = ERROR_SUCCESS;
+
+	bool run(run_func_type func, std::size_t num_handoffs, const char *unit)
+	{
+		LARGE_INTEGER freq;
+		if (!QueryPerformanceFrequency(&freq)) {
+			win_error_code = GetLastError();
+			return false;
+		}
+
+		win_time_perf_frequency = 1.0 / static_cast<bench_time_t>(freq.QuadPart);
+
+		for (template_int_t i = 0; i < tnum_iterations; ++i)
+		{
+			if (!func(stats, false, num_handoffs)) {
+				win_error_code = stats.win_error_code;
+				return false;
+			}
+		}
+
+		time_value_per_handoff = static_cast<bench_time_t>(stats.ticks) * win_time_perf_frequency / static_cast<bench_time_t>(stats.num_handoffs);
+
+		std::cout	<< "-----------------------------------------------\n"
+					<< "Time per " << unit << " (nanoseconds): " << time_value_per_handoff * 1.0e9 << "\n"
+					<< "Num Iterations: " << tnum_iterations << "\n"
+					<< "Performance Frequency: " << freq.QuadPart << "\n"
+					<< "-----------------------------------------------\n"
+					<< std::endl;
+
+		return true;
+	}
+};
+
+using queue_benchmark_t = handoff_benchmark<1000>;
+
+// Each producer pushes num_blocks / tnum_producers blocks in batches of CU_QUEUE_BATCH,
+// consumers pop in batches until everything has come through.
+template <typename queueType, std::size_t tnum_producers, std::size_t tnum_consumers>
+CU_FUNC bool queue_throughput_test(handoff_stats &stats, bool print_vals, std::size_t num_blocks)
+{
+	auto q = std::make_unique<queueType>();
+
+	const std::size_t blocks_per_producer = num_blocks / tnum_producers;
+	const std::size_t total_blocks = blocks_per_producer * tnum_producers;
+
+	std::atomic<std::size_t> num_ready{};
+	std::atomic<bool> go{};
+
+	std::atomic<std::size_t> blocks_left{ total_blocks };
+	std::atomic<std::uint64_t> sum{};
+
+	// written by whichever consumer takes the last block, read after the joins
+	LARGE_INTEGER end_counter{};
+	DWORD end_error_code = ERROR_SUCCESS;
+
+	auto wait_for_go = [&num_ready, &go]() {
+		num_ready.fetch_add(1, std::memory_order_release);
+
+		while (!go.load(std::memory_order_acquire)) {
+			YieldProcessor();
+		}
+	};
+
+	std::array<std::thread, tnum_producers + tnum_consumers> threads;
+
+	for (std::size_t p = 0; p < tnum_producers; ++p) {
+		threads[p] = std::thread([&q, &wait_for_go, blocks_per_producer]() {
+			std::array<queue_block_t, CU_QUEUE_BATCH> batch;
+
+			wait_for_go();
+
+			for (std::size_t i = 0; i < blocks_per_producer; i += batch.size()) {
+				const std::size_t count = (blocks_per_producer - i) < batch.size() ? (blocks_per_producer - i) : batch.size();
+
+				for (std::size_t b = 0; b < count; ++b) {
+					batch[b].fill(static_cast<std::uint64_t>(i + b));
+				}
+
+				queue_push_all(*q, batch.data(), count);
+			}
+		});
+	}
+
+	for (std::size_t c = 0; c < tnum_consumers; ++c) {
+		threads[tnum_producers + c] = std::thread([&q, &wait_for_go, &blocks_left, &sum, &end_counter, &end_error_code]() {
+			std::array<queue_block_t, CU_QUEUE_BATCH> batch;
+			std::uint64_t local_sum = 0;
+
+			wait_for_go();
+
+			while (blocks_left.load(std::memory_order_relaxed) != 0) {
+				const std::size_t count = q->pop_n(batch.data(), batch.size());
+
+				if (count == 0) {
+					YieldProcessor();
+					continue;
+				}
+
+				for (std::size_t b = 0; b < count; ++b) {
+					local_sum += batch[b][0];
+				}
+
+				if (blocks_left.fetch_sub(count, std::memory_order_relaxed) == count) {
+					if (!QueryPerformanceCounter(&end_counter)) {
+						end_error_code = GetLastError();
+					}
+				}
+			}
+
+			sum.fetch_add(local_sum, std::memory_order_relaxed);
+		});
+	}
+
+	while (num_ready.load(std::memory_order_acquire) != threads.size()) {
+		YieldProcessor();
+	}
+
+	// the workers still have to be let go and joined if this fails
+	LARGE_INTEGER start_counter;
+	const bool start_ok = QueryPerformanceCounter(&start_counter) != 0;
+	const DWORD start_error_code = start_ok ? ERROR_SUCCESS : GetLastError();
+
+	go.store(true, std::memory_order_release);
+
+	for (auto &t: threads) {
+		t.join();
+	}
+
+	if (!start_ok || end_error_code != ERROR_SUCCESS) {
+		stats.win_error_code = start_ok ? end_error_code : start_error_code;
+		return false;
+	}
+
+	stats.ticks += end_counter.QuadPart - start_counter.QuadPart;
+	stats.num_handoffs += total_blocks;
+
+	if (print_vals) {
+		std::cout << "sum: " << sum.load() << "\n"
+				  << "expected: " << tnum_producers * (blocks_per_producer * (blocks_per_producer - 1) / 2) << "\n"
+				  << std::endl;
+	}
+
+	return true;
+}
+
+// Round trip of a single block: ping goes out on one queue and comes back on the other
+template <typename queueType>
+CU_FUNC bool queue_latency_test(handoff_stats &stats, bool print_vals, std::size_t num_round_trips)
+{
+	auto ping = std::make_unique<queueType>();
+	auto pong = std::make_unique<queueType>();
+
+	std::atomic<bool> ready{};
+
+	std::thread echo([&ping, &pong, &ready, num_round_trips]() {
+		queue_block_t block;
+
+		ready.store(true, std::memory_order_release);
+
+		for (std::size_t i = 0; i < num_round_trips; ++i) {
+			queue_pop_all(*ping, &block, 1);
+			queue_push_all(*pong, &block, 1);
+		}
+	});
+
+	while (!ready.load(std::memory_order_acquire)) {
+		YieldProcessor();
+	}
+
+	queue_block_t block{};
+	std::uint64_t sum = 0;
+
+	LARGE_INTEGER start_counter;
+	LARGE_INTEGER end_counter;
+
+	const bool start_ok = QueryPerformanceCounter(&start_counter) != 0;
+	DWORD error_code = start_ok ? ERROR_SUCCESS : GetLastError();
+
+	for (std::size_t i = 0; i < num_round_trips; ++i) {
+		block.fill(static_cast<std::uint64_t>(i));
+
+		queue_push_all(*ping, &block, 1);
+		queue_pop_all(*pong, &block, 1);
+
+		sum += block[0];
+	}
+
+	if (!QueryPerformanceCounter(&end_counter) && error_code == ERROR_SUCCESS) {
+		error_code = GetLastError();
+	}
+
+	echo.join();
+
+	if (error_code != ERROR_SUCCESS) {
+		stats.win_error_code = error_code;
+		return false;
+	}
+
+	stats.ticks += end_counter.QuadPart - start_counter.QuadPart;
+	stats.num_handoffs += num_round_trips;
+
+	if (print_vals) {
+		std::cout << CU_STREAM_VALUE(sum) << std::endl;
+	}
+
+	return true;
+}
+
+CU_FUNC bool spsc_throughput_test(handoff_stats &stats, bool print_vals, std::size_t num_blocks)
+{
+	return queue_throughput_test<spsc_queue_test_t, 1, 1>(stats, print_vals, num_blocks);
+}
+
+CU_FUNC bool mpmc_throughput_test(handoff_stats &stats, bool print_vals, std::size_t num_blocks)
+{
+	return queue_throughput_test<mpmc_queue_test_t, 2, 2>(stats, print_vals, num_blocks);
+}
+
+CU_FUNC bool deque_spsc_throughput_test(handoff_stats &stats, bool print_vals, std::size_t num_blocks)
+{
+	return queue_throughput_test<deque_queue_test_t, 1, 1>(stats, print_vals, num_blocks);
+}
+
+CU_FUNC bool deque_mpmc_throughput_test(handoff_stats &stats, bool print_vals, std::size_t num_blocks)
+{
+	return queue_throughput_test<deque_queue_test_t, 2, 2>(stats, print_vals, num_blocks);
+}
+
+CU_FUNC bool spsc_latency_test(handoff_stats &stats, bool print_vals, std::size_t num_round_trips)
+{
+	return queue_latency_test<spsc_queue_test_t>(stats, print_vals, num_round_trips);
+}
+
+CU_FUNC bool mpmc_latency_test(handoff_stats &stats, bool print_vals, std::size_t num_round_trips)
+{
+	return queue_latency_test<mpmc_queue_test_t>(stats, print_vals, num_round_trips);
+}
+
+CU_FUNC bool deque_latency_test(handoff_stats &stats, bool print_vals, std::size_t num_round_trips)
+{
+	return queue_latency_test<deque_queue_test_t>(stats, print_vals, num_round_trips);
+}
+
 CU_FUNC void contig_print()
 {
 	contig1_t lol;
@@ -623,6 +1669,75 @@ CU_FUNC void contig_print()
 	}
 }
 
+// Counts everything that lands in the wrong place: tile indices that don't survive a round trip
+// through tile_coords, elements that aren't visited exactly once by the tile iterator,
+// and elements the transpose puts in the wrong spot.
+template <typename arrayType>
+CU_FUNC std::size_t tiled_array2d_mismatches(std::size_t width, std::size_t height)
+{
+	using size_type = typename arrayType::size_type;
+
+	arrayType a(width, height);
+	arrayType t(height, width);
+
+	std::size_t mismatches = 0;
+
+	for (size_type i = 0; i < a.mem.size(); ++i) {
+		size_type tile_x, tile_y;
+		a.tile_coords(i, tile_x, tile_y);
+
+		mismatches += a.tile_index(tile_x, tile_y) != i;
+	}
+
+	for (size_type y = 0; y < height; ++y) {
+		for (size_type x = 0; x < width; ++x) {
+			a(x, y) = static_cast<typename arrayType::this_type>(y * width + x);
+		}
+	}
+
+	std::vector<std::uint32_t> visits(width * height);
+
+	for (const auto &tile: a.tiles()) {
+		for (size_type y = 0; y < tile.height; ++y) {
+			for (size_type x = 0; x < tile.width; ++x) {
+				const size_type index = (tile.y + y) * width + tile.x + x;
+
+				mismatches += tile(x, y) != static_cast<typename arrayType::this_type>(index);
+				visits[index]++;
+			}
+		}
+	}
+
+	for (auto v: visits) {
+		mismatches += v != 1;
+	}
+
+	mismatches += !transpose(a, t);
+
+	for (size_type y = 0; y < height; ++y) {
+		for (size_type x = 0; x < width; ++x) {
+			mismatches += t(y, x) != a(x, y);
+		}
+	}
+
+	return mismatches;
+}
+
+CU_FUNC void tiled_array2d_test()
+{
+	using line_morton_t = tiled_array2d<std::uint32_t, cache_params_t::num_bytes_per_block, tile_order_morton>;
+	using wide_tile_morton_t = tiled_array2d<std::uint64_t, cache_params_t::num_bytes_per_block, tile_order_morton>;
+
+	std::cout << "tiled_array2d mismatches\n\n"
+			  << "row-major 33x257: " << tiled_array2d_mismatches<tiled_array2d<std::uint32_t>>(33, 257) << "\n"
+			  << "morton line 33x257: " << tiled_array2d_mismatches<line_morton_t>(33, 257) << "\n"
+			  << "morton line 257x33: " << tiled_array2d_mismatches<line_morton_t>(257, 33) << "\n"
+			  << "morton line, non-square tiles 33x257: " << tiled_array2d_mismatches<wide_tile_morton_t>(33, 257) << "\n"
+			  << "morton page 33x257: " << tiled_array2d_mismatches<tiled_morton_array2d<std::uint32_t>>(33, 257) << "\n"
+			  << "morton page 257x33: " << tiled_array2d_mismatches<tiled_morton_array2d<std::uint32_t>>(257, 33) << "\n"
+			  << std::endl;
+}
+
 CU_FUNC void print_constexpr_max()
 {
 	auto m = detail::greatest<1, 2, 3, 4, 5, 6, 7>::value;
@@ -644,6 +1759,7 @@ CU_FUNC void print_cache_params()
 	   << CU_STREAM_VALUE(num_bytes_per_block)
 	   << CU_STREAM_VALUE(num_cache_bytes)
 	   << CU_STREAM_VALUE(num_physical_address_bits)
+	   << CU_STREAM_VALUE(num_bytes_per_page)
 	   << CU_STREAM_VALUE(num_sets)
 	   << CU_STREAM_VALUE(num_set_index_bits)
 	   << CU_STREAM_VALUE(num_block_offset_bits)
@@ -21,8 +21,53 @@ int main()
 	cu::test::vertex_cmem_test_benchmark_t vb{};
 	vb.run(cu::test::vertex_cmem_test, false, CU_DEFAULT_IN_ITERATIONS);
 
+	std::cout << "row-major stencil\n";
+	cu::test::grid_row_stencil_test_benchmark_t gs{};
+	gs.run(cu::test::grid_row_stencil_test, false, CU_GRID_IN_ITERATIONS);
+
+	std::cout << "tiled stencil\n";
+	cu::test::grid_tiled_stencil_test_benchmark_t gts{};
+	gts.run(cu::test::grid_tiled_stencil_test, false, CU_GRID_IN_ITERATIONS);
+
+	std::cout << "row-major transpose\n";
+	cu::test::grid_row_transpose_test_benchmark_t gt{};
+	gt.run(cu::test::grid_row_transpose_test, false, CU_GRID_IN_ITERATIONS);
+
+	std::cout << "tiled transpose\n";
+	cu::test::grid_tiled_transpose_test_benchmark_t gtt{};
+	gtt.run(cu::test::grid_tiled_transpose_test, false, CU_GRID_IN_ITERATIONS);
+
+	std::cout << "spsc throughput\n";
+	cu::test::queue_benchmark_t qs{};
+	qs.run(cu::test::spsc_throughput_test, CU_QUEUE_IN_ITERATIONS, "block");
+
+	std::cout << "mpmc throughput (2 producers, 2 consumers)\n";
+	cu::test::queue_benchmark_t qm{};
+	qm.run(cu::test::mpmc_throughput_test, CU_QUEUE_IN_ITERATIONS, "block");
+
+	std::cout << "locked deque throughput (1 producer, 1 consumer)\n";
+	cu::test::queue_benchmark_t qds{};
+	qds.run(cu::test::deque_spsc_throughput_test, CU_QUEUE_IN_ITERATIONS, "block");
+
+	std::cout << "locked deque throughput (2 producers, 2 consumers)\n";
+	cu::test::queue_benchmark_t qdm{};
+	qdm.run(cu::test::deque_mpmc_throughput_test, CU_QUEUE_IN_ITERATIONS, "block");
+
+	std::cout << "spsc latency\n";
+	cu::test::queue_benchmark_t ls{};
+	ls.run(cu::test::spsc_latency_test, CU_QUEUE_LATENCY_IN_ITERATIONS, "round trip");
+
+	std::cout << "mpmc latency\n";
+	cu::test::queue_benchmark_t lm{};
+	lm.run(cu::test::mpmc_latency_test, CU_QUEUE_LATENCY_IN_ITERATIONS, "round trip");
+
+	std::cout << "locked deque latency\n";
+	cu::test::queue_benchmark_t ld{};
+	ld.run(cu::test::deque_latency_test, CU_QUEUE_LATENCY_IN_ITERATIONS, "round trip");
+
 	cu::test::contig_print();
 	cu::test::print_constexpr_max();
+	cu::test::tiled_array2d_test();
 	cu::test::print_cache_params<u64_t, base_t>();
 	cu::test::print_cache_params<u32_t, base_t>();
 	cu::test::print_cache_params<u16_t, base_t>();